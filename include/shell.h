@@ -10,6 +10,8 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <ctype.h>
+#include <signal.h>
+#include <sys/stat.h>
 
 // Readline headers
 #include <readline/readline.h>
@@ -21,6 +23,11 @@
 #define MAX_PIPE_SEGS 10
 #define MAX_JOBS 50
 #define MAX_VARS 100     // --- NEW ---
+#define READ_BLOCK_SIZE 4096
+#define MAX_OUTPUTS 8    // Max '>' targets per command (fan-out)
+#define ZYGOTE_MSG_MAX 65536 // Max size of one zygote launch request
+#define TEARDOWN_GRACE_MS 100 // Pipeline teardown: window to judge a stage in
+#define TEARDOWN_POLL_MS 10
 #define PROMPT "shell> "
 
 // --- Data Structures ---
@@ -28,7 +35,8 @@
 typedef struct {
     char* args[MAX_ARGS + 1];
     char* inputFile;
-    char* outputFile;
+    char* outputFiles[MAX_OUTPUTS]; // "cmd > a > b" writes to both
+    int num_outputs;
 } SimpleCommand;
 
 typedef struct {
@@ -38,7 +46,10 @@ typedef struct {
 } Pipeline;
 
 typedef struct {
-    pid_t pid;
+    pid_t pid;       // Also the job's process group ID
+    pid_t last_pid;  // Last stage: its status is the job's status
+    int last_status; // Last stage's waitpid() status, once it exits
+    pid_t fan_pids[MAX_PIPE_SEGS]; // Fan-out helpers (0 = none)
     char* cmd_name;
     int is_running;
 } Job;
@@ -55,6 +66,9 @@ extern Job job_list[MAX_JOBS];
 extern int job_count;
 extern Variable var_storage[MAX_VARS]; // --- NEW ---
 extern int var_count;                 // --- NEW ---
+extern int zygote_fd;                 // -1 unless started with -z
+extern pid_t shell_pgid;              // The shell's own process group
+extern int shell_is_interactive;      // stdin is a terminal
 
 
 // --- Function Prototypes ---
@@ -70,10 +84,23 @@ void      list_jobs(); // The missing promise!
 void handle_assignment(char* assignment_str);
 void expand_variables(Pipeline* pipeline);
 void list_variables();
+int  read_builtin(char** arglist, char* inputFile);
+int  run_builtin(Pipeline* pipeline);
 
 
 // --- from execute.c ---
 int  execute_pipeline(Pipeline* pipeline);
-void add_job(pid_t pid, Pipeline* pipeline);
+int  add_job(pid_t pgid, pid_t last_pid, pid_t* fan_pids,
+             Pipeline* pipeline, int is_running);
+void remove_job(int index);
+int  continue_job(int index, int foreground);
+void init_job_control();
+void join_process_group(pid_t pgid, int foreground);
+void setup_redirection(SimpleCommand* cmd, int fanout_fd);
+
+// --- from zygote.c ---
+void  start_zygote();
+pid_t zygote_launch(SimpleCommand* cmd, int in_fd, int out_fd,
+                    pid_t pgid, int foreground);
 
 #endif // SHELL_H
\ No newline at end of file
@@ -1,7 +1,12 @@
+#define _GNU_SOURCE // for tee() and splice()
 #include "shell.h"
 
-// (setup_redirection is unchanged, include it here)
-static void setup_redirection(SimpleCommand* cmd) {
+#define FANOUT_CHUNK (64 * 1024) // One default pipe buffer
+
+// (setup_redirection is updated for fan-out)
+// With more than one '>' target, stdout goes to 'fanout_fd' instead,
+// the write end of a pipe read by start_fanout()'s process.
+void setup_redirection(SimpleCommand* cmd, int fanout_fd) {
     if (cmd->inputFile) {
         int fd_in = open(cmd->inputFile, O_RDONLY);
         if (fd_in == -1) {
@@ -14,8 +19,8 @@ static void setup_redirection(SimpleCommand* cmd) {
         }
         close(fd_in);
     }
-    if (cmd->outputFile) {
-        int fd_out = open(cmd->outputFile, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (cmd->num_outputs == 1) {
+        int fd_out = open(cmd->outputFiles[0], O_WRONLY | O_CREAT | O_TRUNC, 0644);
         if (fd_out == -1) {
             perror("open (output)");
             exit(1);
@@ -25,19 +30,211 @@ static void setup_redirection(SimpleCommand* cmd) {
             exit(1);
         }
         close(fd_out);
+    } else if (cmd->num_outputs > 1) {
+        if (dup2(fanout_fd, STDOUT_FILENO) == -1) {
+            perror("dup2 (fan-out)");
+            exit(1);
+        }
+        close(fanout_fd);
+    }
+}
+
+
+/**
+ * @brief Moves exactly 'len' bytes from pipe 'in' to 'out'.
+ * Uses splice() so the data stays in the kernel; falls back to
+ * read()/write() if 'out' doesn't support splicing.
+ */
+static int splice_all(int in, int out, size_t len) {
+    char buf[4096];
+    while (len > 0) {
+        ssize_t n = splice(in, NULL, out, NULL, len, SPLICE_F_MOVE);
+        if (n == -1 && errno == EINVAL) {
+            // Fallback: plain copy through user space.
+            n = read(in, buf, len < sizeof(buf) ? len : sizeof(buf));
+            if (n > 0 && write(out, buf, n) != n) return -1;
+        }
+        if (n == -1 && errno == EINTR) continue;
+        if (n <= 0) return -1;
+        len -= n;
+    }
+    return 0;
+}
+
+/**
+ * @brief Body of the fan-out process: copies 'in_fd' to every fd in 'out_fds'.
+ * Needs at least two targets (start_fanout() only runs it then).
+ *
+ * tee() duplicates the pipe contents into one scratch pipe per extra
+ * target without consuming them, each scratch pipe is spliced into its
+ * file, and finally the original data is spliced into the last file.
+ * Nothing is copied through user space unless a target refuses splice.
+ */
+static void run_fanout(int in_fd, int* out_fds, int num_outs) {
+    int scratch[MAX_OUTPUTS][2];
+    for (int k = 0; k < num_outs - 1; k++) {
+        if (pipe(scratch[k]) == -1) {
+            perror("pipe (fan-out)");
+            exit(1);
+        }
+    }
+
+    while (1) {
+        ssize_t len = tee(in_fd, scratch[0][1], FANOUT_CHUNK, 0);
+        if (len == -1 && errno == EINTR) continue;
+        if (len == -1) {
+            perror("tee");
+            exit(1);
+        }
+        if (len == 0) break; // Writer closed the pipe: EOF
+
+        // The scratch pipes are empty at this point, so each one has
+        // room for everything the first tee() saw.
+        for (int k = 1; k < num_outs - 1; k++) {
+            if (tee(in_fd, scratch[k][1], len, 0) != len) {
+                perror("tee");
+                exit(1);
+            }
+        }
+        for (int k = 0; k < num_outs - 1; k++) {
+            if (splice_all(scratch[k][0], out_fds[k], len) == -1) {
+                perror("splice");
+                exit(1);
+            }
+        }
+        if (splice_all(in_fd, out_fds[num_outs - 1], len) == -1) {
+            perror("splice");
+            exit(1);
+        }
+    }
+    exit(0);
+}
+
+/**
+ * @brief Starts the fan-out process for a command with several '>' targets.
+ * 'close_fd' is a pipe end the shell holds that the helper must not keep open.
+ * On success, '*write_fd' is the pipe end the command should write to.
+ * @return The helper's PID, 0 if no fan-out is needed, or -1 on error.
+ */
+static pid_t start_fanout(SimpleCommand* cmd, int close_fd, int* write_fd) {
+    *write_fd = -1;
+    if (cmd->num_outputs < 2) {
+        return 0;
+    }
+
+    int fds[2];
+    if (pipe(fds) == -1) {
+        perror("pipe");
+        return -1;
+    }
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
+
+    if (pid == 0) {
+        // --- Fan-out Process ---
+        close(fds[1]);
+        if (close_fd != STDIN_FILENO) close(close_fd);
+
+        int out_fds[MAX_OUTPUTS];
+        for (int k = 0; k < cmd->num_outputs; k++) {
+            out_fds[k] = open(cmd->outputFiles[k], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (out_fds[k] == -1) {
+                perror("open (output)");
+                exit(1);
+            }
+        }
+        run_fanout(fds[0], out_fds, cmd->num_outputs);
+    }
+
+    // --- Parent Process ---
+    close(fds[0]);
+    *write_fd = fds[1];
+    return pid;
+}
+
+
+// -----------------------------------------------------------------
+// --- JOB CONTROL (process groups + terminal) ---
+// Every pipeline runs in its own process group, led by its first
+// stage. A job's 'pid' is that group ID.
+// -----------------------------------------------------------------
+
+/**
+ * @brief Puts the shell in its own process group and takes the terminal.
+ * Called once at startup, before the zygote is forked.
+ */
+void init_job_control() {
+    shell_is_interactive = isatty(STDIN_FILENO);
+    if (!shell_is_interactive) {
+        return;
+    }
+
+    // So tcsetpgrp() and ^Z don't stop the shell itself.
+    signal(SIGTTOU, SIG_IGN);
+    signal(SIGTTIN, SIG_IGN);
+    signal(SIGTSTP, SIG_IGN);
+
+    shell_pgid = getpid();
+    setpgid(shell_pgid, shell_pgid); // Fails harmlessly if we lead a session
+    shell_pgid = getpgrp();
+    tcsetpgrp(STDIN_FILENO, shell_pgid);
+}
+
+/**
+ * @brief Runs in a new child before exec: joins group 'pgid' (0 = new
+ * group led by this process) and, for foreground jobs, takes the terminal.
+ * Both the child and the shell do this, so it doesn't matter who runs first.
+ */
+void join_process_group(pid_t pgid, int foreground) {
+    if (pgid == 0) pgid = getpid();
+    setpgid(0, pgid);
+
+    if (shell_is_interactive && foreground) {
+        signal(SIGTTOU, SIG_IGN);
+        tcsetpgrp(STDIN_FILENO, pgid);
     }
+
+    // Undo the shell's ignored signals; exec would keep them ignored.
+    signal(SIGTTOU, SIG_DFL);
+    signal(SIGTTIN, SIG_DFL);
+    signal(SIGTSTP, SIG_DFL);
 }
 
+/**
+ * @brief Gives the terminal to group 'pgid' (or back to the shell).
+ */
+static void give_terminal_to(pid_t pgid) {
+    if (shell_is_interactive) {
+        tcsetpgrp(STDIN_FILENO, pgid);
+    }
+}
 
-// (add_job is unchanged, include it here)
-void add_job(pid_t pid, Pipeline* pipeline) {
+
+// (add_job now also records what fg needs to finish the job)
+// 'last_pid' is the last stage (its status is the job's status) and
+// 'fan_pids' has one entry per stage (0 = no fan-out helper).
+// @return The job's index in job_list, or -1 if the list is full.
+int add_job(pid_t pgid, pid_t last_pid, pid_t* fan_pids,
+            Pipeline* pipeline, int is_running) {
     if (job_count >= MAX_JOBS) {
         fprintf(stderr, "Job list full. Cannot add new job.\n");
-        return;
+        return -1;
     }
     
-    job_list[job_count].pid = pid;
-    job_list[job_count].is_running = 1;
+    Job* job = &job_list[job_count];
+    job->pid = pgid;
+    job->last_pid = last_pid;
+    job->last_status = 0;
+    job->is_running = is_running;
+    for (int i = 0; i < MAX_PIPE_SEGS; i++) {
+        job->fan_pids[i] = (i < pipeline->num_commands) ? fan_pids[i] : 0;
+    }
     
     char* job_name = (char*)malloc(MAX_LEN);
     job_name[0] = '\0';
@@ -51,11 +248,279 @@ void add_job(pid_t pid, Pipeline* pipeline) {
         }
     }
     
-    job_list[job_count].cmd_name = job_name;
-    printf("[Job %d] (PID %d) started: %s\n", 
-           job_count + 1, pid, job_list[job_count].cmd_name);
+    job->cmd_name = job_name;
+    printf("[Job %d] (PID %d) %s: %s\n", 
+           job_count + 1, pgid, is_running ? "started" : "Stopped",
+           job->cmd_name);
     
-    job_count++;
+    return job_count++;
+}
+
+/**
+ * @brief Drops job 'index' from the job list.
+ */
+void remove_job(int index) {
+    free(job_list[index].cmd_name);
+    job_list[index] = job_list[job_count - 1];
+    job_count--;
+}
+
+/**
+ * @brief Implements 'fg' and 'bg': sends SIGCONT to job 'index'.
+ * With 'foreground', also hands it the terminal and waits for it.
+ * @return The job's exit status (that of its last stage).
+ */
+int continue_job(int index, int foreground) {
+    Job* job = &job_list[index];
+    pid_t pgid = job->pid;
+
+    if (!foreground) {
+        job->is_running = 1;
+        printf("[Job %d] %s&\n", index + 1, job->cmd_name);
+        kill(-pgid, SIGCONT);
+        return 0;
+    }
+
+    printf("%s\n", job->cmd_name);
+    give_terminal_to(pgid);
+    kill(-pgid, SIGCONT);
+
+    // Wait for every process in the group.
+    int status = 0;
+    pid_t pid;
+    while ((pid = waitpid(-pgid, &status, WUNTRACED)) > 0) {
+        if (WIFSTOPPED(status)) {
+            job->is_running = 0;
+            printf("\n[Job %d] Stopped: %s\n", index + 1, job->cmd_name);
+            give_terminal_to(shell_pgid);
+            return 1;
+        }
+        if (pid == job->last_pid) {
+            job->last_status = status;
+        }
+    }
+    give_terminal_to(shell_pgid);
+
+    // Fan-out helpers live outside the group; let them finish their files.
+    for (int i = 0; i < MAX_PIPE_SEGS; i++) {
+        if (job->fan_pids[i] > 0) waitpid(job->fan_pids[i], NULL, 0);
+    }
+
+    status = job->last_status;
+    int exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    remove_job(index);
+    return exit_status;
+}
+
+
+// -----------------------------------------------------------------
+// --- EARLY PIPELINE TEARDOWN ---
+// Once a stage's reader has exited, its stdout is a dead pipe. If
+// the stage then keeps making write() calls that all fail (e.g. it
+// ignores SIGPIPE and loops on EPIPE), or sits blocked in a pipe
+// write, it will never finish on its own. Such a stage gets SIGPIPE,
+// and SIGTERM one grace period later if it is still at it. CPU use
+// alone proves nothing: a stage may compute for a long time before
+// writing a file of its own.
+// -----------------------------------------------------------------
+
+// One look at a stage, taken from /proc.
+typedef struct {
+    unsigned long long io;     // rchar + wchar: bytes actually moved
+    unsigned long long syscw;  // write() calls, including failed ones
+    int blocked_on_pipe;    // Sleeping inside a pipe write
+} StageSample;
+
+/**
+ * @brief Fills 's' from /proc/<pid>/{stat,io,wchan}.
+ * @return 0 on success, -1 if the stage can't be inspected.
+ */
+static int sample_stage(pid_t pid, StageSample* s) {
+    char path[64];
+    char buf[512];
+    FILE* f;
+
+    // /proc/<pid>/stat: the state is field 3.
+    snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+    if ((f = fopen(path, "r")) == NULL) return -1;
+    size_t n = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    char* fields = strrchr(buf, ')'); // The command name may contain spaces
+    char state;
+    if (fields == NULL || sscanf(fields + 2, "%c", &state) != 1) {
+        return -1;
+    }
+
+    // /proc/<pid>/io: without it we can't tell progress apart, so give up.
+    snprintf(path, sizeof(path), "/proc/%d/io", pid);
+    if ((f = fopen(path, "r")) == NULL) return -1;
+    unsigned long long rchar = 0, wchar = 0;
+    int found = 0;
+    while (fgets(buf, sizeof(buf), f) != NULL) {
+        found += sscanf(buf, "rchar: %llu", &rchar);
+        found += sscanf(buf, "wchar: %llu", &wchar);
+        found += sscanf(buf, "syscw: %llu", &s->syscw);
+    }
+    fclose(f);
+    if (found != 3) return -1;
+    s->io = rchar + wchar;
+
+    // /proc/<pid>/wchan: the kernel function it is sleeping in.
+    s->blocked_on_pipe = 0;
+    snprintf(path, sizeof(path), "/proc/%d/wchan", pid);
+    if (state == 'S' && (f = fopen(path, "r")) != NULL) {
+        if (fgets(buf, sizeof(buf), f) != NULL) {
+            s->blocked_on_pipe = (strncmp(buf, "pipe_write", 10) == 0 ||
+                                  strncmp(buf, "pipe_wait_writable", 18) == 0);
+        }
+        fclose(f);
+    }
+    return 0;
+}
+
+/**
+ * @brief Did the stage look stuck or spinning between 'before' and 'after'?
+ * Spinning means it kept calling write() without moving a single byte;
+ * stuck means it is asleep in a pipe write. Any successful I/O rules
+ * both out.
+ */
+static int stage_is_stuck(StageSample* before, StageSample* after) {
+    if (after->io != before->io) return 0;
+    return after->syscw > before->syscw || after->blocked_on_pipe;
+}
+
+/**
+ * @brief Waits for a foreground pipeline whose group is 'pids[0]'.
+ *
+ * The last stage is waited for first, since its status is the
+ * pipeline's status. Upstream stages are then reaped as they exit;
+ * any whose stdout has become a dead pipe are watched every
+ * TEARDOWN_GRACE_MS and signalled only if their writes keep failing
+ * or they are blocked in a pipe write (see stage_is_stuck()). A stage
+ * doing its own work, like 'dd of=file | true' or a long computation
+ * before 'sort -o file', is left alone until it finishes.
+ *
+ * Sets '*stopped' if the job was stopped with ^Z; it is then in the
+ * job list and its processes are left unreaped.
+ * @return The exit status of the last stage.
+ */
+static int wait_foreground(Pipeline* pipeline, pid_t* pids, pid_t* fan_pids,
+                           int num_cmds, int* stopped) {
+    pid_t pgid = pids[0];
+    pid_t last_pid = pids[num_cmds - 1];
+    int status = 0;
+    int exit_status = 0;
+    *stopped = 0;
+
+    waitpid(last_pid, &status, WUNTRACED);
+    if (WIFSTOPPED(status)) {
+        give_terminal_to(shell_pgid);
+        add_job(pgid, last_pid, fan_pids, pipeline, 0);
+        *stopped = 1;
+        return 1;
+    }
+    int last_status = status;
+    exit_status = WIFEXITED(status) ? WEXITSTATUS(status) : 1;
+    pids[num_cmds - 1] = 0;
+
+    // Per-stage teardown state.
+    StageSample base[num_cmds];
+    int watched_ms[num_cmds];   // -1 = not watched yet, -2 = can't be
+    int signals_sent[num_cmds];
+    for (int i = 0; i < num_cmds; i++) {
+        watched_ms[i] = -1;
+        signals_sent[i] = 0;
+    }
+
+    int remaining = num_cmds - 1;
+    while (remaining > 0) {
+        // 1. Reap whatever has finished; notice ^Z.
+        int watching = 0;
+        for (int i = 0; i < num_cmds - 1; i++) {
+            if (pids[i] == 0) continue;
+            pid_t r = waitpid(pids[i], &status, WNOHANG | WUNTRACED);
+            if (r == pids[i] && WIFSTOPPED(status)) {
+                give_terminal_to(shell_pgid);
+                int index = add_job(pgid, last_pid, fan_pids, pipeline, 0);
+                if (index != -1) job_list[index].last_status = last_status;
+                *stopped = 1;
+                return exit_status;
+            }
+            if (r == pids[i] || r == -1) {
+                pids[i] = 0;
+                remaining--;
+            }
+        }
+
+        // 2. Watch stages whose only reader (the next stage) is gone.
+        for (int i = 0; i < num_cmds - 1; i++) {
+            if (pids[i] == 0 || pids[i + 1] != 0) continue;
+            if (pipeline->commands[i].num_outputs > 0) continue; // Not a pipe
+            if (watched_ms[i] == -2) continue; // Can't inspect it
+
+            StageSample now;
+            if (watched_ms[i] == -1) {
+                watched_ms[i] = (sample_stage(pids[i], &base[i]) == 0) ? 0 : -2;
+                watching |= (watched_ms[i] == 0);
+                continue;
+            }
+            watching = 1;
+            watched_ms[i] += TEARDOWN_POLL_MS;
+            if (watched_ms[i] < TEARDOWN_GRACE_MS) continue;
+            if (sample_stage(pids[i], &now) == -1) continue;
+
+            if (stage_is_stuck(&base[i], &now) && signals_sent[i] < 2) {
+                kill(pids[i], signals_sent[i] == 0 ? SIGPIPE : SIGTERM);
+                signals_sent[i]++;
+            }
+            base[i] = now;
+            watched_ms[i] = 0;
+        }
+        if (remaining == 0) break;
+
+        if (watching) {
+            usleep(TEARDOWN_POLL_MS * 1000);
+            continue;
+        }
+
+        // 3. Nothing to watch: just block until some stage changes.
+        pid_t r = waitpid(-pgid, &status, WUNTRACED);
+        if (r == -1) break; // No stages left
+        for (int i = 0; i < num_cmds - 1; i++) {
+            if (pids[i] != r) continue;
+            if (WIFSTOPPED(status)) {
+                give_terminal_to(shell_pgid);
+                int index = add_job(pgid, last_pid, fan_pids, pipeline, 0);
+                if (index != -1) job_list[index].last_status = last_status;
+                *stopped = 1;
+                return exit_status;
+            }
+            pids[i] = 0;
+            remaining--;
+        }
+    }
+
+    give_terminal_to(shell_pgid);
+    return exit_status;
+}
+
+/**
+ * @brief Cleans up after a pipeline fails part-way through launching.
+ * Takes the terminal back, closes 'in_fd', kills the stages already
+ * started and reaps them along with their fan-out helpers.
+ */
+static void abort_pipeline(pid_t* pids, pid_t* fan_pids, int num_cmds, int in_fd) {
+    give_terminal_to(shell_pgid);
+    if (in_fd != STDIN_FILENO) close(in_fd);
+
+    for (int i = 0; i < num_cmds; i++) {
+        if (pids[i] > 0) kill(pids[i], SIGKILL);
+    }
+    for (int i = 0; i < num_cmds; i++) {
+        if (pids[i] > 0) waitpid(pids[i], NULL, 0);
+        if (fan_pids[i] > 0) waitpid(fan_pids[i], NULL, 0);
+    }
 }
 
 
@@ -63,70 +528,73 @@ void add_job(pid_t pid, Pipeline* pipeline) {
  * @brief Executes a full pipeline of one or more commands.
  * --- NEW (v7) ---
  * Now captures and returns the *exit status* of the last command.
+ * Each pipeline gets its own process group (see wait_foreground()).
  * @return Returns the exit status (0 for success, non-zero for failure).
  */
 int execute_pipeline(Pipeline* pipeline) {
     int num_cmds = pipeline->num_commands;
+    int foreground = !pipeline->is_background;
     
     // --- NEW (v7): Variables to hold the process status ---
-    int status = 0;      // This holds the "report" from waitpid
     int exit_status = 0; // This holds the final exit code (e.g., 0 or 1)
-    
-    // --- Case 1: Single Command ---
-    if (num_cmds == 1) {
-        pid_t pid = fork();
-        if (pid == -1) {
-            perror("fork");
-            return 1; // Return 1 (failure)
-        }
-        
-        if (pid == 0) {
-            // --- Child Process ---
-            setup_redirection(&pipeline->commands[0]);
-            execvp(pipeline->commands[0].args[0], pipeline->commands[0].args);
-            perror("execvp");
-            exit(127); // 127 is the standard code for "command not found"
-        } else {
-            // --- Parent Process ---
-            if (!pipeline->is_background) {
-                // --- MODIFIED (v7) ---
-                // We now pass &status to capture the report
-                waitpid(pid, &status, 0);
-                
-                // --- NEW (v7): Decode the status report ---
-                if (WIFEXITED(status)) {
-                    // WIFEXITED: "Was it a normal exit?" (not a crash)
-                    // WEXITSTATUS: "What was its exit code?"
-                    exit_status = WEXITSTATUS(status);
-                } else {
-                    // The process crashed or was killed. Report failure.
-                    exit_status = 1; 
-                }
-            } else {
-                // Background job: add to list, report 0 (success)
-                add_job(pid, pipeline);
-                exit_status = 0; 
-            }
-        }
-        return exit_status; // Return the final code
-    }
-    
-    // --- Case 2: Pipeline (num_cmds > 1) ---
+    int stopped = 0;     // Set if the user pressed ^Z
+
     int pipe_fds[2];
     int in_fd = STDIN_FILENO;
     pid_t pids[num_cmds];
+    pid_t fan_pids[num_cmds];
+    pid_t pgid = 0; // 0 until the first stage starts and leads the group
 
     for (int i = 0; i < num_cmds; i++) {
-        // (Forking and piping logic is unchanged)
+        pids[i] = 0;
+        fan_pids[i] = 0;
+    }
+
+    // (A single command is just a pipeline with one stage)
+    for (int i = 0; i < num_cmds; i++) {
         SimpleCommand* cmd = &pipeline->commands[i];
+        int fan_fd;
+        pid_t fan_pid = start_fanout(cmd, in_fd, &fan_fd);
+        if (fan_pid == -1) {
+            abort_pipeline(pids, fan_pids, num_cmds, in_fd);
+            return 1;
+        }
+        fan_pids[i] = fan_pid;
+
         if (i < num_cmds - 1) {
-            if (pipe(pipe_fds) == -1) { perror("pipe"); return 1; }
+            if (pipe(pipe_fds) == -1) {
+                perror("pipe");
+                if (fan_fd != -1) close(fan_fd);
+                abort_pipeline(pids, fan_pids, num_cmds, in_fd);
+                return 1;
+            }
         }
-        pids[i] = fork();
-        if (pids[i] == -1) { perror("fork"); return 1; }
 
-        if (pids[i] == 0) {
-            // --- Child Process (in pipe) ---
+        // In zygote mode the launcher does the fork + exec for us.
+        pid_t pid;
+        if (zygote_fd != -1) {
+            int out_fd = STDOUT_FILENO;
+            if (fan_fd != -1) out_fd = fan_fd;
+            else if (i < num_cmds - 1) out_fd = pipe_fds[1];
+            pid = zygote_launch(cmd, in_fd, out_fd, pgid, foreground);
+        } else {
+            pid = fork();
+            if (pid == -1) perror("fork");
+        }
+        if (pid == -1) {
+            // (zygote_launch reports its own errors)
+            if (fan_fd != -1) close(fan_fd);
+            if (i < num_cmds - 1) {
+                close(pipe_fds[0]);
+                close(pipe_fds[1]);
+            }
+            abort_pipeline(pids, fan_pids, num_cmds, in_fd);
+            return 1;
+        }
+
+        if (pid == 0) {
+            // --- Child Process ---
+            join_process_group(pgid, foreground);
             if (in_fd != STDIN_FILENO) {
                 dup2(in_fd, STDIN_FILENO);
                 close(in_fd);
@@ -136,15 +604,23 @@ int execute_pipeline(Pipeline* pipeline) {
                 close(pipe_fds[0]);
                 close(pipe_fds[1]);
             }
-            setup_redirection(cmd);
+            setup_redirection(cmd, fan_fd);
             execvp(cmd->args[0], cmd->args);
             perror("execvp");
-            exit(127);
+            exit(127); // 127 is the standard code for "command not found"
         } else {
-            // --- Parent Process (in pipe) ---
+            // --- Parent Process ---
+            // Same as the child does, so there's no race over who goes first.
+            pids[i] = pid;
+            if (pgid == 0) pgid = pid;
+            setpgid(pid, pgid);
+            if (foreground) give_terminal_to(pgid);
+
+            if (fan_fd != -1) close(fan_fd);
             if (in_fd != STDIN_FILENO) {
                 close(in_fd);
             }
+            in_fd = STDIN_FILENO;
             if (i < num_cmds - 1) {
                 close(pipe_fds[1]);
                 in_fd = pipe_fds[0];
@@ -152,26 +628,19 @@ int execute_pipeline(Pipeline* pipeline) {
         }
     }
 
-    // --- Parent: Wait for ALL children in the pipeline ---
-    if (!pipeline->is_background) {
-        for (int i = 0; i < num_cmds; i++) {
-            // --- MODIFIED (v7) ---
-            // We only care about the status of the *LAST* command
-            if (i == num_cmds - 1) {
-                waitpid(pids[i], &status, 0); // Get status for last cmd
-                if (WIFEXITED(status)) {
-                    exit_status = WEXITSTATUS(status);
-                } else {
-                    exit_status = 1;
-                }
-            } else {
-                waitpid(pids[i], NULL, 0); // Wait for others, but ignore status
-            }
+    if (foreground) {
+        exit_status = wait_foreground(pipeline, pids, fan_pids, num_cmds, &stopped);
+
+        // Wait for the fan-outs to finish writing their files.
+        // (A stopped job's helpers are waited for by 'fg' instead.)
+        for (int i = 0; i < num_cmds && !stopped; i++) {
+            if (fan_pids[i] > 0) waitpid(fan_pids[i], NULL, 0);
         }
     } else {
-        add_job(pids[0], pipeline);
-        exit_status = 0; // Background pipe launch is "success"
+        // Background job: add to list, report 0 (success)
+        add_job(pgid, pids[num_cmds - 1], fan_pids, pipeline, 1);
+        exit_status = 0;
     }
 
     return exit_status; // Return the final command's status
-}
\ No newline at end of file
+}
@@ -6,30 +6,49 @@
 Job job_list[MAX_JOBS];
 int job_count = 0;
 
+// --- NEW: Global Job Control State ---
+pid_t shell_pgid = 0;
+int shell_is_interactive = 0;
+
 // --- NEW: Global Variable Storage Definition (v8) ---
 Variable var_storage[MAX_VARS];
 int var_count = 0;
 
 
-// (reap_zombies is unchanged from v7)
+// (reap_zombies now reports a job once its whole process group is gone)
 void reap_zombies() {
     int status;
     pid_t pid;
     while ((pid = waitpid(-1, &status, WNOHANG)) > 0) {
         for (int i = 0; i < job_count; i++) {
-            if (job_list[i].pid == pid) {
-                char* status_msg;
-                if (WIFEXITED(status)) status_msg = "Done";
-                else if (WIFSIGNALED(status)) status_msg = "Terminated";
-                else status_msg = "Stopped";
-                printf("\n[Job %d] %s: %s\n", i + 1, status_msg, job_list[i].cmd_name);
-                free(job_list[i].cmd_name);
-                job_list[i] = job_list[job_count - 1];
-                job_count--;
-                break;
+            if (job_list[i].last_pid == pid) {
+                job_list[i].last_status = status;
+            }
+            // Fan-out helpers aren't in the job's group; track them here.
+            for (int k = 0; k < MAX_PIPE_SEGS; k++) {
+                if (job_list[i].fan_pids[k] == pid) job_list[i].fan_pids[k] = 0;
             }
         }
     }
+
+    // Stages finish in any order; the job is done when none are left
+    // and its fan-out helpers have finished writing.
+    for (int i = job_count - 1; i >= 0; i--) {
+        int helpers_running = 0;
+        for (int k = 0; k < MAX_PIPE_SEGS; k++) {
+            if (job_list[i].fan_pids[k] > 0) helpers_running = 1;
+        }
+        if (!helpers_running &&
+            kill(-job_list[i].pid, 0) == -1 && errno == ESRCH) {
+            status = job_list[i].last_status;
+            char* status_msg;
+            if (WIFEXITED(status)) status_msg = "Done";
+            else if (WIFSIGNALED(status)) status_msg = "Terminated";
+            else status_msg = "Stopped";
+            printf("\n[Job %d] %s: %s\n", i + 1, status_msg, job_list[i].cmd_name);
+            remove_job(i);
+        }
+    }
 }
 
 // (execute_command_block is updated for v8)
@@ -55,13 +74,7 @@ void execute_command_block(char* block[], int count) {
             expand_variables(pipeline);
 
             // (Check for built-ins in a block)
-            int builtin_status = 0;
-            if (pipeline->num_commands == 1 && !pipeline->is_background &&
-                pipeline->commands[0].inputFile == NULL && 
-                pipeline->commands[0].outputFile == NULL) {
-                
-                builtin_status = handle_builtin(pipeline->commands[0].args);
-            }
+            int builtin_status = run_builtin(pipeline);
             if (builtin_status == 0) {
                 execute_pipeline(pipeline);
             }
@@ -73,10 +86,18 @@ void execute_command_block(char* block[], int count) {
 }
 
 
-int main() {
+int main(int argc, char* argv[]) {
     char* cmdline;
     Pipeline* pipeline;
 
+    init_job_control();
+
+    // --- NEW: Optional zygote launcher ('-z') ---
+    // Must be forked before readline sets anything up.
+    if (argc > 1 && strcmp(argv[1], "-z") == 0) {
+        start_zygote();
+    }
+
     rl_bind_key('\t', rl_complete);
 
     while (1) {
@@ -130,12 +151,7 @@ int main() {
                 // --- NEW: Expand variables in the 'if' condition ---
                 expand_variables(pipeline); 
                 
-                int builtin_status = 0;
-                if (pipeline->num_commands == 1 && !pipeline->is_background &&
-                    pipeline->commands[0].inputFile == NULL && 
-                    pipeline->commands[0].outputFile == NULL) {
-                     builtin_status = handle_builtin(pipeline->commands[0].args);
-                }
+                int builtin_status = run_builtin(pipeline);
                 
                 if (builtin_status != 0) {
                     exit_status = (builtin_status == 1) ? 0 : 1;
@@ -174,7 +190,7 @@ int main() {
                 if (pipeline->num_commands == 1 &&
                     !pipeline->is_background &&
                     pipeline->commands[0].inputFile == NULL &&
-                    pipeline->commands[0].outputFile == NULL &&
+                    pipeline->commands[0].num_outputs == 0 &&
                     pipeline->commands[0].args[1] == NULL &&
                     strchr(pipeline->commands[0].args[0], '=') != NULL) 
                 {
@@ -185,13 +201,7 @@ int main() {
                     // --- NEW (v8): Expand variables ---
                     expand_variables(pipeline);
                     
-                    int builtin_status = 0;
-                    if (pipeline->num_commands == 1 && !pipeline->is_background &&
-                        pipeline->commands[0].inputFile == NULL && 
-                        pipeline->commands[0].outputFile == NULL) {
-                        
-                        builtin_status = handle_builtin(pipeline->commands[0].args);
-                    }
+                    int builtin_status = run_builtin(pipeline);
 
                     if (builtin_status == 0) {
                         execute_pipeline(pipeline);
@@ -2,7 +2,7 @@
 #include <ctype.h>
 
 // (Helper function prototypes)
-static void parse_simple_command(char* cmd_str, SimpleCommand* cmd);
+static int  parse_simple_command(char* cmd_str, SimpleCommand* cmd);
 
 // -----------------------------------------------------------------
 // --- FIX FOR YOUR 'undefined reference' ERROR ---
@@ -16,8 +16,10 @@ void list_jobs() {
     }
     
     for (int i = 0; i < job_count; i++) {
-        printf("  [Job %d] (PID %d) Running: %s\n", 
-               i + 1, job_list[i].pid, job_list[i].cmd_name);
+        printf("  [Job %d] (PID %d) %s: %s\n", 
+               i + 1, job_list[i].pid,
+               job_list[i].is_running ? "Running" : "Stopped",
+               job_list[i].cmd_name);
     }
 }
 
@@ -122,6 +124,174 @@ void list_variables() {
     }
 }
 
+// -----------------------------------------------------------------
+// --- NEW: THE 'read' BUILT-IN ---
+// -----------------------------------------------------------------
+
+/**
+ * @brief Helper to store KEY=VALUE through the normal variable store.
+ */
+static void set_variable(char* key, char* value) {
+    char* assignment = (char*)malloc(strlen(key) + strlen(value) + 2);
+    sprintf(assignment, "%s=%s", key, value);
+    handle_assignment(assignment);
+    free(assignment);
+}
+
+/**
+ * @brief Reads one record (up to 'delim') from 'fd' into a new string.
+ *
+ * A regular file is read in big blocks; whatever we read past the
+ * delimiter is handed back with lseek(), so the file offset ends up
+ * exactly after the record. That matters because the shell's own
+ * stdin is shared with readline and with the children we fork.
+ * Pipes and terminals can't be rewound, so there we read one byte
+ * at a time and never take more than the record.
+ *
+ * @return 1 if the delimiter was found, 0 on end-of-file.
+ */
+static int read_record(int fd, int delim, int raw, char** out) {
+    char block[READ_BLOCK_SIZE];
+    struct stat st;
+    size_t want = 1;
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+        want = sizeof(block);
+    }
+
+    size_t cap = 64, len = 0;
+    char* line = (char*)malloc(cap);
+    int escaped = 0;
+    int found = 0;
+
+    while (!found) {
+        ssize_t n = read(fd, block, want);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            perror("read");
+            break;
+        }
+        if (n == 0) break; // EOF
+
+        ssize_t i;
+        for (i = 0; i < n; i++) {
+            char c = block[i];
+            if (escaped) {
+                escaped = 0;
+                if (c == '\n') continue; // Line continuation
+            } else if (!raw && c == '\\') {
+                escaped = 1;
+                continue;
+            } else if ((unsigned char)c == delim) {
+                found = 1;
+                i++;
+                break;
+            }
+            if (len + 1 >= cap) {
+                cap *= 2;
+                line = (char*)realloc(line, cap);
+            }
+            line[len++] = c;
+        }
+
+        // Give back the bytes we read past the delimiter.
+        if (found && i < n) {
+            lseek(fd, (off_t)(i - n), SEEK_CUR);
+        }
+    }
+
+    line[len] = '\0';
+    *out = line;
+    return found;
+}
+
+/**
+ * @brief Implements 'read [-r] [-d delim] [VAR...]'.
+ * Splits the record on whitespace; the last VAR gets the rest of the line.
+ * With no VAR, the whole record goes into REPLY.
+ * Reads from 'inputFile' if given ('read X < file'), else from stdin.
+ */
+int read_builtin(char** arglist, char* inputFile) {
+    int raw = 0;
+    int delim = '\n';
+    int i = 1;
+
+    for (; arglist[i] != NULL && arglist[i][0] == '-'; i++) {
+        if (strcmp(arglist[i], "--") == 0) {
+            i++;
+            break;
+        } else if (strcmp(arglist[i], "-r") == 0) {
+            raw = 1;
+        } else if (strcmp(arglist[i], "-d") == 0) {
+            if (arglist[i + 1] == NULL) {
+                fprintf(stderr, "read: -d: option requires an argument\n");
+                return 2;
+            }
+            delim = (unsigned char)arglist[++i][0]; // "" means NUL
+        } else {
+            fprintf(stderr, "read: invalid option: %s\n", arglist[i]);
+            return 2;
+        }
+    }
+
+    char* default_vars[] = { "REPLY", NULL };
+    char** vars = (arglist[i] != NULL) ? &arglist[i] : default_vars;
+
+    int fd = STDIN_FILENO;
+    if (inputFile != NULL) {
+        fd = open(inputFile, O_RDONLY);
+        if (fd == -1) {
+            perror("read");
+            return 2;
+        }
+    }
+
+    char* line;
+    int found = read_record(fd, delim, raw, &line);
+    if (fd != STDIN_FILENO) close(fd);
+
+    char* rest = line;
+    for (int v = 0; vars[v] != NULL; v++) {
+        while (*rest != '\0' && isspace((unsigned char)*rest)) rest++;
+
+        if (vars[v + 1] == NULL) {
+            // Last variable: take the rest, minus trailing whitespace.
+            char* end = rest + strlen(rest);
+            while (end > rest && isspace((unsigned char)end[-1])) end--;
+            *end = '\0';
+            set_variable(vars[v], rest);
+        } else {
+            char* word = rest;
+            while (*rest != '\0' && !isspace((unsigned char)*rest)) rest++;
+            if (*rest != '\0') *rest++ = '\0';
+            set_variable(vars[v], word);
+        }
+    }
+
+    free(line);
+    return found ? 1 : 2; // EOF counts as failure
+}
+
+/**
+ * @brief Runs a single foreground command as a built-in, if it is one.
+ * Built-ins never take '>'; only 'read' takes '<'.
+ * @return 0 if not a built-in, else handle_builtin()'s 1 (ok) / 2 (failed).
+ */
+int run_builtin(Pipeline* pipeline) {
+    SimpleCommand* cmd = &pipeline->commands[0];
+    if (pipeline->num_commands != 1 || pipeline->is_background ||
+        cmd->num_outputs > 0) {
+        return 0;
+    }
+
+    if (strcmp(cmd->args[0], "read") == 0) {
+        return read_builtin(cmd->args, cmd->inputFile);
+    }
+    if (cmd->inputFile != NULL) {
+        return 0;
+    }
+    return handle_builtin(cmd->args);
+}
+
 // -----------------------------------------------------------------
 // BUILT-IN COMMAND HANDLER (MODIFIED for v8)
 // -----------------------------------------------------------------
@@ -153,6 +323,8 @@ int handle_builtin(char** arglist) {
         printf("  VAR=value   - Assign a variable.\n");
         printf("  echo $VAR   - Use a variable.\n");
         printf("  set         - Show local variables.\n");
+        printf("  read [-r] [-d delim] VAR... - Read a line into variables.\n");
+        printf("  fg / bg [n] - Resume job n in the foreground/background.\n");
         // ... (add other help text) ...
         return 1;
     }
@@ -162,6 +334,21 @@ int handle_builtin(char** arglist) {
         return 1;
     }
 
+    // --- NEW: 'fg' and 'bg' [job number, default: the latest job] ---
+    if (strcmp(cmd, "fg") == 0 || strcmp(cmd, "bg") == 0) {
+        int job_num = job_count;
+        if (arglist[1] != NULL) {
+            char* num = (arglist[1][0] == '%') ? arglist[1] + 1 : arglist[1];
+            job_num = atoi(num);
+        }
+        if (job_num < 1 || job_num > job_count) {
+            fprintf(stderr, "%s: no such job\n", cmd);
+            return 2; // FAILED
+        }
+        int status = continue_job(job_num - 1, cmd[0] == 'f');
+        return (status == 0) ? 1 : 2;
+    }
+
     // --- NEW: The 'set' command ---
     if (strcmp(cmd, "set") == 0) {
         list_variables();
@@ -213,11 +400,15 @@ Pipeline* parse_cmdline(char* cmdline) {
             return NULL;
         }
 
-        parse_simple_command(pipe_segment, &pipeline->commands[pipeline->num_commands]);
+        if (parse_simple_command(pipe_segment, &pipeline->commands[pipeline->num_commands]) == -1) {
+            pipeline->num_commands++; // So free_pipeline() frees this one too
+            free_pipeline(pipeline);
+            return NULL;
+        }
         
         if (pipeline->commands[pipeline->num_commands].args[0] == NULL) {
              if (pipeline->commands[pipeline->num_commands].inputFile ||
-                 pipeline->commands[pipeline->num_commands].outputFile) {
+                 pipeline->commands[pipeline->num_commands].num_outputs > 0) {
                  fprintf(stderr, "Syntax error: redirection with no command.\n");
                  free_pipeline(pipeline);
                  return NULL;
@@ -235,10 +426,11 @@ Pipeline* parse_cmdline(char* cmdline) {
     return pipeline;
 }
 
-static void parse_simple_command(char* cmd_str, SimpleCommand* cmd) {
+// Returns -1 on a syntax error that must reject the whole command line.
+static int parse_simple_command(char* cmd_str, SimpleCommand* cmd) {
     int arg_index = 0;
     cmd->inputFile = NULL;
-    cmd->outputFile = NULL;
+    cmd->num_outputs = 0;
     
     char* token;
     char* rest = cmd_str;
@@ -251,7 +443,7 @@ static void parse_simple_command(char* cmd_str, SimpleCommand* cmd) {
             token = strsep(&rest, " \t\n");
             if (token == NULL || *token == '\0') {
                 fprintf(stderr, "Syntax error: no file for input redirection.\n");
-                return; 
+                return 0; 
             }
             cmd->inputFile = strdup(token);
         }
@@ -259,9 +451,14 @@ static void parse_simple_command(char* cmd_str, SimpleCommand* cmd) {
             token = strsep(&rest, " \t\n");
             if (token == NULL || *token == '\0') {
                 fprintf(stderr, "Syntax error: no file for output redirection.\n");
-                return;
+                return 0;
+            }
+            if (cmd->num_outputs >= MAX_OUTPUTS) {
+                fprintf(stderr, "Syntax error: too many output redirections.\n");
+                cmd->args[arg_index] = NULL;
+                return -1;
             }
-            cmd->outputFile = strdup(token);
+            cmd->outputFiles[cmd->num_outputs++] = strdup(token);
         }
         else {
             if (arg_index < MAX_ARGS) {
@@ -271,6 +468,7 @@ static void parse_simple_command(char* cmd_str, SimpleCommand* cmd) {
         }
     }
     cmd->args[arg_index] = NULL;
+    return 0;
 }
 
 void free_pipeline(Pipeline* pipeline) {
@@ -279,7 +477,7 @@ void free_pipeline(Pipeline* pipeline) {
         SimpleCommand* cmd = &pipeline->commands[i];
         for (int j = 0; cmd->args[j] != NULL; j++) free(cmd->args[j]);
         if (cmd->inputFile) free(cmd->inputFile);
-        if (cmd->outputFile) free(cmd->outputFile);
+        for (int j = 0; j < cmd->num_outputs; j++) free(cmd->outputFiles[j]);
     }
     free(pipeline);
 }
\ No newline at end of file
@@ -0,0 +1,275 @@
+#define _GNU_SOURCE // for clone() and execvpe()
+#include "shell.h"
+#include <sched.h>
+#include <sys/socket.h>
+
+// -----------------------------------------------------------------
+// --- ZYGOTE LAUNCHER ---
+// A tiny helper forked at startup, before readline and history are
+// set up. execute_pipeline() sends it launch requests over a
+// socketpair and it does the fork + exec, so launching a command
+// doesn't get slower as the interactive shell grows.
+// -----------------------------------------------------------------
+
+// Our end of the socketpair, or -1 when zygote mode is off.
+int zygote_fd = -1;
+
+// Fixed part of a launch request. It is followed by the argv strings,
+// the environment strings, then the input file and output file names
+// if present, each one NUL-terminated. The stdin, stdout and working
+// directory fds travel alongside as SCM_RIGHTS.
+typedef struct {
+    int argc;
+    int envc;
+    int has_input;
+    int has_output;
+    pid_t pgid;     // Process group to join (0 = start a new one)
+    int foreground; // Take the terminal?
+} LaunchHeader;
+
+#define ZYGOTE_NUM_FDS 3
+#define ZYGOTE_STACK_SIZE (128 * 1024)
+
+extern char** environ;
+
+// Everything the launched process needs, unpacked from one request.
+typedef struct {
+    LaunchHeader* hdr;
+    SimpleCommand cmd;
+    char** envp;
+    int fds[ZYGOTE_NUM_FDS];
+    int sock;
+} LaunchRequest;
+
+// Stack for clone(). Without CLONE_VM the child gets its own copy of
+// our memory, so one buffer can be reused for every launch.
+static char launch_stack[ZYGOTE_STACK_SIZE] __attribute__((aligned(16)));
+
+/**
+ * @brief Sends 'len' bytes plus 'ZYGOTE_NUM_FDS' fds over 'sock'.
+ */
+static int send_with_fds(int sock, void* data, size_t len, int* fds) {
+    char control[CMSG_SPACE(sizeof(int) * ZYGOTE_NUM_FDS)];
+    struct iovec iov = { .iov_base = data, .iov_len = len };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int) * ZYGOTE_NUM_FDS);
+    memcpy(CMSG_DATA(cmsg), fds, sizeof(int) * ZYGOTE_NUM_FDS);
+
+    return sendmsg(sock, &msg, MSG_NOSIGNAL) == (ssize_t)len ? 0 : -1;
+}
+
+/**
+ * @brief Receives one request and its fds from 'sock'.
+ * @return Bytes received, or <= 0 on EOF/error.
+ */
+static ssize_t recv_with_fds(int sock, void* data, size_t len, int* fds) {
+    char control[CMSG_SPACE(sizeof(int) * ZYGOTE_NUM_FDS)];
+    struct iovec iov = { .iov_base = data, .iov_len = len };
+    struct msghdr msg = {0};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    ssize_t n;
+    do {
+        n = recvmsg(sock, &msg, 0);
+    } while (n == -1 && errno == EINTR);
+    if (n <= 0) return n;
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (cmsg == NULL || cmsg->cmsg_type != SCM_RIGHTS ||
+        cmsg->cmsg_len != CMSG_LEN(sizeof(int) * ZYGOTE_NUM_FDS)) {
+        return -1;
+    }
+    memcpy(fds, CMSG_DATA(cmsg), sizeof(int) * ZYGOTE_NUM_FDS);
+    return n;
+}
+
+/**
+ * @brief Entry point of a launched process (runs on 'launch_stack').
+ */
+static int launch_child(void* arg) {
+    LaunchRequest* req = (LaunchRequest*)arg;
+
+    close(req->sock);
+    join_process_group(req->hdr->pgid, req->hdr->foreground);
+    dup2(req->fds[0], STDIN_FILENO);
+    dup2(req->fds[1], STDOUT_FILENO);
+    if (fchdir(req->fds[2]) == -1) {
+        perror("fchdir");
+        exit(1);
+    }
+    for (int i = 0; i < ZYGOTE_NUM_FDS; i++) close(req->fds[i]);
+
+    setup_redirection(&req->cmd, -1);
+    execvpe(req->cmd.args[0], req->cmd.args, req->envp);
+    perror("execvp");
+    exit(127);
+}
+
+/**
+ * @brief Main loop of the zygote process. Never returns.
+ */
+static void zygote_main(int sock) {
+    char buf[ZYGOTE_MSG_MAX];
+
+    while (1) {
+        LaunchRequest req;
+        req.sock = sock;
+        ssize_t n = recv_with_fds(sock, buf, sizeof(buf), req.fds);
+        if (n <= 0) exit(0); // Shell went away
+
+        // 1. Unpack the request (all strings point into 'buf').
+        LaunchHeader* hdr = (LaunchHeader*)buf;
+        SimpleCommand* cmd = &req.cmd;
+        char* p = buf + sizeof(LaunchHeader);
+        req.hdr = hdr;
+        for (int i = 0; i < hdr->argc; i++) {
+            cmd->args[i] = p;
+            p += strlen(p) + 1;
+        }
+        cmd->args[hdr->argc] = NULL;
+        req.envp = (char**)malloc((hdr->envc + 1) * sizeof(char*));
+        for (int i = 0; i < hdr->envc; i++) {
+            req.envp[i] = p;
+            p += strlen(p) + 1;
+        }
+        req.envp[hdr->envc] = NULL;
+        cmd->inputFile = NULL;
+        if (hdr->has_input) {
+            cmd->inputFile = p;
+            p += strlen(p) + 1;
+        }
+        cmd->num_outputs = 0;
+        if (hdr->has_output) {
+            cmd->outputFiles[cmd->num_outputs++] = p;
+        }
+
+        // 2. Launch it. CLONE_PARENT makes the new process a child of
+        //    the *shell*, so waitpid(), jobs and reaping work as usual.
+        pid_t pid = clone(launch_child, launch_stack + ZYGOTE_STACK_SIZE,
+                          CLONE_PARENT | SIGCHLD, &req);
+        if (pid == -1) perror("clone");
+
+        // 3. Report the PID (or -1) back to the shell.
+        free(req.envp);
+        for (int i = 0; i < ZYGOTE_NUM_FDS; i++) close(req.fds[i]);
+        send(sock, &pid, sizeof(pid), MSG_NOSIGNAL);
+    }
+}
+
+/**
+ * @brief Forks the zygote. Call this before readline is initialized.
+ */
+void start_zygote() {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) == -1) {
+        perror("socketpair");
+        return;
+    }
+
+    pid_t pid = fork();
+    if (pid == -1) {
+        perror("fork");
+        close(sv[0]);
+        close(sv[1]);
+        return;
+    }
+    if (pid == 0) {
+        close(sv[0]);
+        zygote_main(sv[1]);
+    }
+
+    close(sv[1]);
+    zygote_fd = sv[0];
+}
+
+/**
+ * @brief Packs 'str' into the request buffer.
+ * @return 0 on success, -1 if it doesn't fit.
+ */
+static int pack_string(char* buf, size_t* len, const char* str) {
+    size_t n = strlen(str) + 1;
+    if (*len + n > ZYGOTE_MSG_MAX) return -1;
+    memcpy(buf + *len, str, n);
+    *len += n;
+    return 0;
+}
+
+/**
+ * @brief Asks the zygote to run 'cmd' with the given stdin/stdout,
+ * in process group 'pgid' (0 = a new group).
+ * The current environment goes along, since readline keeps LINES and
+ * COLUMNS up to date in it.
+ * Only the input file and a single output file are sent; fan-out
+ * targets are already resolved into 'out_fd' by the caller.
+ * If the zygote has gone away, zygote mode is switched off and we fall
+ * back to a plain fork(), so callers must handle a return value of 0.
+ * @return The new PID, 0 in a fallback child, or -1 on error.
+ */
+pid_t zygote_launch(SimpleCommand* cmd, int in_fd, int out_fd,
+                    pid_t pgid, int foreground) {
+    char buf[ZYGOTE_MSG_MAX];
+    LaunchHeader hdr = {0};
+    hdr.pgid = pgid;
+    hdr.foreground = foreground;
+    size_t len = sizeof(LaunchHeader);
+    int too_long = 0;
+
+    for (int i = 0; cmd->args[i] != NULL; i++) {
+        too_long |= pack_string(buf, &len, cmd->args[i]);
+        hdr.argc++;
+    }
+    for (int i = 0; environ[i] != NULL; i++) {
+        too_long |= pack_string(buf, &len, environ[i]);
+        hdr.envc++;
+    }
+    if (cmd->inputFile) {
+        too_long |= pack_string(buf, &len, cmd->inputFile);
+        hdr.has_input = 1;
+    }
+    if (cmd->num_outputs == 1) {
+        too_long |= pack_string(buf, &len, cmd->outputFiles[0]);
+        hdr.has_output = 1;
+    }
+    if (too_long) {
+        fprintf(stderr, "zygote: command too long\n");
+        return -1;
+    }
+    memcpy(buf, &hdr, sizeof(hdr));
+
+    // The zygote still sits in the directory we started in.
+    int cwd_fd = open(".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (cwd_fd == -1) {
+        perror("open (cwd)");
+        return -1;
+    }
+
+    int fds[ZYGOTE_NUM_FDS] = { in_fd, out_fd, cwd_fd };
+    pid_t pid = -1;
+    int ok = send_with_fds(zygote_fd, buf, len, fds) == 0 &&
+             recv(zygote_fd, &pid, sizeof(pid), 0) == sizeof(pid);
+    close(cwd_fd);
+
+    if (!ok) {
+        fprintf(stderr, "zygote: launcher not responding, using fork()\n");
+        close(zygote_fd);
+        zygote_fd = -1;
+        pid = fork();
+        if (pid == -1) perror("fork");
+        return pid;
+    }
+    if (pid == -1) {
+        fprintf(stderr, "zygote: could not launch %s\n", cmd->args[0]);
+    }
+    return pid;
+}